@@ -6,8 +6,10 @@
 #include <limits>
 #include <algorithm>
 
-// Более точная константа π
-const double M_PI = 3.14159265358979323846;
+// Более точная константа π (в GCC/Clang <cmath> уже определяет M_PI)
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
 
 // Структура для хранения 3D точки
 struct Point3D {
@@ -32,6 +34,21 @@ std::vector<Point3D> generate_random_points(size_t num_points, double min_coord,
     return points;
 }
 
+// Функция для генерации случайных начальных фаз (в градусах) для сегментов
+std::vector<double> generate_phases(size_t num_segments) {
+    std::vector<double> phases(num_segments);
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> dis(0.0, 360.0);
+
+    for (size_t k = 0; k < num_segments; ++k) {
+        phases[k] = dis(gen);
+    }
+
+    return phases;
+}
+
 // Функция для поворота точек вокруг осей X, Y, Z
 void rotate(std::vector<Point3D>& points, double angleX, double angleY, double angleZ) {
     size_t n = points.size();
@@ -83,6 +100,209 @@ void rotate(std::vector<Point3D>& points, double angleX, double angleY, double a
     }
 }
 
+// Уровень точности векторизованного sincos.
+// Погрешности измерены относительно std::sin/std::cos на углах анимации
+enum class TrigAccuracy {
+    Fast,    // минимаксные полиномы 7-й и 6-й степени, погрешность до 1.1e-7
+    Precise  // полиномы fdlibm 13-й и 14-й степени, погрешность до 1.4e-15
+};
+
+// Округление к ближайшему целому без вызова библиотечной функции:
+// прибавление и вычитание 1.5 * 2^52 отбрасывает дробную часть.
+// В отличие от std::floor, GCC векторизует это без -fno-trapping-math.
+// Верно для |x| < 2^51 и только без -ffast-math (/fp:fast), иначе
+// компилятор сократит выражение до x.
+inline double round_nearest(double x) {
+    const double shifter = 6755399441055744.0; // 0x1.8p52
+    return (x + shifter) - shifter;
+}
+
+// Синус и косинус угла в градусах без обращения к libm.
+// Угол приводится к [-45, 45] вычитанием ближайшего кратного 90 (в градусах
+// это делается почти без потери точности), затем считаются полиномы,
+// а квадрант выбирается тернарными операторами, чтобы цикл векторизовался.
+// Допустимые углы: |degrees| < 1e14, дальше k * 90 перестает быть точным.
+template <TrigAccuracy Accuracy>
+inline void sincos_deg(double degrees, double& s, double& c) {
+    const double k = round_nearest(degrees * (1.0 / 90.0));
+    // Номер квадранта приводится к [-2, 2] еще в double, поэтому
+    // преобразование в int не переполняется при больших углах
+    const int quadrant = static_cast<int>(k - 4.0 * round_nearest(k * 0.25));
+    const double r = (degrees - k * 90.0) * (M_PI / 180.0);
+    const double z = r * r;
+
+    double sin_r, cos_r;
+    if constexpr (Accuracy == TrigAccuracy::Precise) {
+        sin_r = r + r * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03
+            + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06
+            + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+        // Поправка из fdlibm: 1 - z / 2 считается с учетом ошибки округления
+        const double hz = 0.5 * z;
+        const double w = 1.0 - hz;
+        cos_r = w + (((1.0 - w) - hz) + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03
+            + z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07
+            + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11))))));
+    }
+    else {
+        sin_r = r + r * z * (-1.6666664413349797e-01 + z * (8.332647186978275e-03
+            + z * -1.9566919992485378e-04));
+        cos_r = 1.0 + z * (-4.999997976119188e-01 + z * (4.166050343601605e-02
+            + z * -1.3642348325571786e-03));
+    }
+
+    // Квадрант 1 и 3 меняет синус и косинус местами, знаки задают биты квадранта
+    const bool swap = (quadrant & 1) != 0;
+    const double s_abs = swap ? cos_r : sin_r;
+    const double c_abs = swap ? sin_r : cos_r;
+    s = (quadrant & 2) ? -s_abs : s_abs;
+    c = ((quadrant + 1) & 2) ? -c_abs : c_abs;
+}
+
+// Количество сегментов, обрабатываемых за один шаг: синусы и косинусы
+// блока (6 массивов по 64 double) остаются в кэше L1 до поворота точек
+const size_t SINCOS_BLOCK = 64;
+
+// Количество точек в одной порции параллельного цикла. Работа делится
+// по точкам, а не по сегментам, поэтому потоки загружены одинаково
+// при любом размере сегмента
+const size_t POINT_BLOCK = 4096;
+
+// Расчет синусов и косинусов для блока углов.
+// #pragma omp simd требует OpenMP 4.0 (см. флаги сборки перед main).
+// Векторизация проверена только в GCC (-fopt-info-vec)
+template <TrigAccuracy Accuracy>
+inline void sincos_block(const double* degrees, double* s, double* c, size_t count) {
+#pragma omp simd
+    for (size_t j = 0; j < count; ++j) {
+        sincos_deg<Accuracy>(degrees[j], s[j], c[j]);
+    }
+}
+
+template <TrigAccuracy Accuracy>
+void rotate_per_point_impl(std::vector<Point3D>& points,
+    const double* anglesX, const double* anglesY, const double* anglesZ,
+    size_t segment_size) {
+    size_t n = points.size();
+    size_t num_chunks = n / POINT_BLOCK + (n % POINT_BLOCK != 0);
+
+#pragma omp parallel for
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        size_t begin = chunk * POINT_BLOCK;
+        size_t end = std::min(begin + POINT_BLOCK, n);
+
+        // Сегменты, которые задевает порция точек [begin, end)
+        size_t first_segment = begin / segment_size;
+        size_t last_segment = (end - 1) / segment_size + 1;
+
+        for (size_t first = first_segment; first < last_segment; first += SINCOS_BLOCK) {
+            size_t count = std::min(SINCOS_BLOCK, last_segment - first);
+
+            // Синусы и косинусы сегментов блока
+            double sinX[SINCOS_BLOCK], cosX[SINCOS_BLOCK];
+            double sinY[SINCOS_BLOCK], cosY[SINCOS_BLOCK];
+            double sinZ[SINCOS_BLOCK], cosZ[SINCOS_BLOCK];
+            sincos_block<Accuracy>(anglesX + first, sinX, cosX, count);
+            sincos_block<Accuracy>(anglesY + first, sinY, cosY, count);
+            sincos_block<Accuracy>(anglesZ + first, sinZ, cosZ, count);
+
+            // Поворот вокруг осей X, Y, Z за один проход
+            for (size_t j = 0; j < count; ++j) {
+                size_t segment_begin = (first + j) * segment_size;
+                size_t from = std::max(segment_begin, begin);
+                size_t to = segment_begin + std::min(segment_size, end - segment_begin);
+                for (size_t i = from; i < to; ++i) {
+                    double x = points[i].x, y = points[i].y, z = points[i].z;
+
+                    double y1 = y * cosX[j] - z * sinX[j];
+                    double z1 = y * sinX[j] + z * cosX[j];
+
+                    double x2 = x * cosY[j] + z1 * sinY[j];
+                    double z2 = -x * sinY[j] + z1 * cosY[j];
+
+                    points[i].x = x2 * cosZ[j] - y1 * sinZ[j];
+                    points[i].y = x2 * sinZ[j] + y1 * cosZ[j];
+                    points[i].z = z2;
+                }
+            }
+        }
+    }
+}
+
+// Количество сегментов по segment_size точек (без переполнения при больших segment_size)
+size_t count_segments(size_t num_points, size_t segment_size) {
+    return num_points / segment_size + (num_points % segment_size != 0);
+}
+
+// Функция для поворота точек, у каждой из которых (или у каждого сегмента
+// из segment_size подряд идущих точек) свои углы поворота.
+// Каждый массив углов должен содержать не меньше ceil(n / segment_size) элементов.
+// Порядок поворотов такой же, как в rotate: сначала X, затем Y, затем Z.
+// Возвращает false, если входные данные некорректны и точки не повернуты.
+bool rotate_per_point(std::vector<Point3D>& points,
+    const std::vector<double>& anglesX,
+    const std::vector<double>& anglesY,
+    const std::vector<double>& anglesZ,
+    size_t segment_size = 1,
+    TrigAccuracy accuracy = TrigAccuracy::Precise) {
+    if (segment_size == 0) {
+        std::cerr << "rotate_per_point: размер сегмента должен быть положительным\n";
+        return false;
+    }
+
+    size_t num_segments = count_segments(points.size(), segment_size);
+    if (anglesX.size() < num_segments || anglesY.size() < num_segments || anglesZ.size() < num_segments) {
+        std::cerr << "rotate_per_point: нужно " << num_segments << " углов на каждую ось\n";
+        return false;
+    }
+
+    if (accuracy == TrigAccuracy::Precise) {
+        rotate_per_point_impl<TrigAccuracy::Precise>(points, anglesX.data(), anglesY.data(), anglesZ.data(),
+            segment_size);
+    }
+    else {
+        rotate_per_point_impl<TrigAccuracy::Fast>(points, anglesX.data(), anglesY.data(), anglesZ.data(),
+            segment_size);
+    }
+    return true;
+}
+
+// Максимальное отклонение sincos_deg от std::sin/std::cos на массиве углов.
+// Эталонный угол сначала приводится к [0, 360), иначе ошибка округления
+// при переводе больших углов в радианы превышает погрешность sincos_deg
+double max_sincos_error(const std::vector<double>& angles, TrigAccuracy accuracy) {
+    double max_error = 0.0;
+    for (size_t k = 0; k < angles.size(); ++k) {
+        double s, c;
+        if (accuracy == TrigAccuracy::Precise) {
+            sincos_deg<TrigAccuracy::Precise>(angles[k], s, c);
+        }
+        else {
+            sincos_deg<TrigAccuracy::Fast>(angles[k], s, c);
+        }
+        double radians = std::fmod(angles[k], 360.0) * M_PI / 180.0;
+        max_error = std::max(max_error, std::abs(s - std::sin(radians)));
+        max_error = std::max(max_error, std::abs(c - std::cos(radians)));
+    }
+    return max_error;
+}
+
+// Заполнение углов для покадровой анимации: каждый сегмент вращается
+// со своей фазой, угол растет со временем t
+void animate_angles(std::vector<double>& angles, const std::vector<double>& phases,
+    double base, double speed, double t) {
+    size_t m = angles.size();
+    for (size_t k = 0; k < m; ++k) {
+        angles[k] = base + speed * t + phases[k];
+    }
+}
+
+// Сборка (режим 2 использует if constexpr и #pragma omp simd):
+//   MSVC:      /std:c++17 /openmp:experimental /O2, без /fp:fast.
+//              С /std:c++14 if constexpr дает C4984, а при обычном /openmp
+//              omp simd игнорируется. Отчет /Qvec-report:2 для sincos_block
+//              не снимался, векторизация в MSVC не проверена.
+//   GCC/Clang: -std=c++17 -fopenmp -O2, без -ffast-math.
+//              Цикл sincos_block векторизуется (-fopt-info-vec).
 int main() {
     // Установка локали для корректного отображения сообщений на русском
     setlocale(LC_ALL, "Russian");
@@ -123,6 +343,40 @@ int main() {
     double angleY = 45.0; // Поворот вокруг оси Y
     double angleZ = 60.0; // Поворот вокруг оси Z
 
+    // Выбор режима поворота
+    int mode;
+    std::cout << "Режим поворота (1 - общий угол, 2 - свой угол у каждой точки/сегмента): ";
+    while (!(std::cin >> mode) || (mode != 1 && mode != 2)) {
+        std::cout << "Некорректный ввод. Пожалуйста, введите 1 или 2: ";
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+
+    size_t segment_size = 1;
+    TrigAccuracy accuracy = TrigAccuracy::Precise;
+    std::vector<double> phases;
+    if (mode == 2) {
+        std::cout << "Введите размер сегмента (1 - свой угол у каждой точки): ";
+        while (!(std::cin >> segment_size) || segment_size == 0 || segment_size > num_points) {
+            std::cout << "Некорректный ввод. Пожалуйста, введите целое число от 1 до " << num_points << ": ";
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+
+        int accuracy_choice;
+        std::cout << "Точность sin/cos (1 - быстрая, 2 - точная): ";
+        while (!(std::cin >> accuracy_choice) || (accuracy_choice != 1 && accuracy_choice != 2)) {
+            std::cout << "Некорректный ввод. Пожалуйста, введите 1 или 2: ";
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        accuracy = accuracy_choice == 1 ? TrigAccuracy::Fast : TrigAccuracy::Precise;
+
+        // Случайная начальная фаза для каждого сегмента
+        size_t num_segments = count_segments(num_points, segment_size);
+        phases = generate_phases(num_segments);
+    }
+
     // Задание количества итераций для измерения времени
     int iterations;
     std::cout << "Введите количество итераций: " << std::endl;
@@ -133,15 +387,32 @@ int main() {
 
     std::cout << "Выполняется " << iterations << " итераций поворота...\n";
 
+    std::vector<double> anglesX(phases.size()), anglesY(phases.size()), anglesZ(phases.size());
+    const double time_step = 0.04; // Шаг анимации между итерациями, секунд
+
     for (int i = 0; i < iterations; ++i) {
         // Создание копии оригинальных точек для каждой итерации
         std::vector<Point3D> points = original_points;
 
+        // Углы для текущего кадра анимации (в замер времени не входят)
+        if (mode == 2) {
+            double t = i * time_step;
+            animate_angles(anglesX, phases, angleX, 90.0, t);
+            animate_angles(anglesY, phases, angleY, 45.0, t);
+            animate_angles(anglesZ, phases, angleZ, 30.0, t);
+        }
+
         // Засекаем время начала
         double start_time = omp_get_wtime();
 
         // Выполнение поворота
-        rotate(points, angleX, angleY, angleZ);
+        if (mode == 1) {
+            rotate(points, angleX, angleY, angleZ);
+        }
+        else if (!rotate_per_point(points, anglesX, anglesY, anglesZ, segment_size, accuracy)) {
+            std::cout << "Поворот не выполнен, измерение прервано.\n";
+            return 1;
+        }
 
         // Засекаем время окончания
         double end_time = omp_get_wtime();
@@ -167,5 +438,12 @@ int main() {
     std::cout << "Максимальное время: " << max_time << " секунд\n";
     std::cout << "Среднее время: " << avg_time << " секунд\n";
 
+    // Проверка выбранного sincos по std::sin/std::cos на углах последнего кадра
+    if (mode == 2) {
+        double max_error = std::max({ max_sincos_error(anglesX, accuracy),
+            max_sincos_error(anglesY, accuracy), max_sincos_error(anglesZ, accuracy) });
+        std::cout << "Максимальная погрешность sin/cos: " << max_error << "\n";
+    }
+
     return 0;
 }